@@ -1,6 +1,7 @@
 #ifndef OPENMC_CELL_H
 #define OPENMC_CELL_H
 
+#include <array>
 #include <cstdint>
 #include <limits>
 #include <memory> // for unique_ptr
@@ -8,13 +9,16 @@
 #include <unordered_map>
 #include <vector>
 
+#include <gsl/gsl>
 #include "hdf5.h"
 #include "pugixml.hpp"
 #include "dagmc.h"
 
 #include "openmc/constants.h"
+#include "openmc/flat_id_map.h"
 #include "openmc/neighbor_list.h"
 #include "openmc/position.h"
+#include "openmc/small_vector.h"
 #include "openmc/surface.h"
 
 namespace openmc {
@@ -28,6 +32,10 @@ constexpr int FILL_MATERIAL {1};
 constexpr int FILL_UNIVERSE {2};
 constexpr int FILL_LATTICE {3};
 
+//! Tag identifying the concrete type of a Cell, used to dispatch the hot
+//! contains/distance calls without a virtual function table lookup.
+enum class CellKind : uint8_t {csg, dag};
+
 // TODO: Convert to enum
 constexpr int32_t OP_LEFT_PAREN   {std::numeric_limits<int32_t>::max()};
 constexpr int32_t OP_RIGHT_PAREN  {std::numeric_limits<int32_t>::max() - 1};
@@ -35,6 +43,39 @@ constexpr int32_t OP_COMPLEMENT   {std::numeric_limits<int32_t>::max() - 2};
 constexpr int32_t OP_INTERSECTION {std::numeric_limits<int32_t>::max() - 3};
 constexpr int32_t OP_UNION        {std::numeric_limits<int32_t>::max() - 4};
 
+//! 16-bit equivalents of the operator tokens, used by the packed stream in
+//! model::cell_rpn_tokens16.  The encoding matches the 32-bit one: operators
+//! occupy the top of the value range with OP16_UNION lowest, so a single
+//! comparison separates half-space tokens from operators in either width.
+constexpr int16_t OP16_LEFT_PAREN   {std::numeric_limits<int16_t>::max()};
+constexpr int16_t OP16_RIGHT_PAREN  {std::numeric_limits<int16_t>::max() - 1};
+constexpr int16_t OP16_COMPLEMENT   {std::numeric_limits<int16_t>::max() - 2};
+constexpr int16_t OP16_INTERSECTION {std::numeric_limits<int16_t>::max() - 3};
+constexpr int16_t OP16_UNION        {std::numeric_limits<int16_t>::max() - 4};
+
+//==============================================================================
+//! Inline copy of the coefficients of a surface referenced by a region token.
+//
+//! For the common plane, cylinder, and sphere types the surface sense can be
+//! computed from these coefficients alone, so the hot contains functions
+//! avoid a pointer chase into model::surfaces and a virtual evaluate() call
+//! per token.  Exotic surface types are marked generic and keep using the
+//! virtual interface.
+//==============================================================================
+
+struct SurfaceCoeffs {
+  enum class Kind : int8_t {
+    generic, x_plane, y_plane, z_plane, plane, sphere, x_cylinder, y_cylinder,
+    z_cylinder
+  };
+
+  //! Meaning depends on kind: (a,b,c,d) for a general plane, the axis
+  //! coordinate in d for axis-aligned planes, and the center in (a,b,c) with
+  //! the squared radius in d for spheres and cylinders.
+  double a, b, c, d;
+  Kind kind {Kind::generic};
+};
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -44,11 +85,46 @@ class Universe;
 class UniversePartitioner;
 
 namespace model {
-  extern std::vector<std::unique_ptr<Cell>> cells;
-  extern std::unordered_map<int32_t, int32_t> cell_map;
+  //! Non-owning pointers to all cells, indexed as everywhere else in the
+  //! code.  The objects themselves live in the csg_cells/dag_cells arenas
+  //! declared below so that cells of the same type are contiguous in memory.
+  extern std::vector<Cell*> cells;
+  extern FlatIdMap cell_map;
 
   extern std::vector<std::unique_ptr<Universe>> universes;
-  extern std::unordered_map<int32_t, int32_t> universe_map;
+  extern FlatIdMap universe_map;
+
+  //! \brief Flattened copies of the per-cell RPN data used on the hot path.
+  //
+  //! The `contains` and `distance` functions only need a cell's RPN tokens,
+  //! so those are mirrored here in structure-of-arrays form after the
+  //! geometry is read.  The token streams for all cells are packed
+  //! back-to-back in `cell_rpn_tokens`; `cell_rpn_offsets[i]` gives the start
+  //! of cell i's stream and `cell_rpn_offsets[i+1]` its end.  This way a
+  //! particle traversal streams just the few bytes it needs per cell rather
+  //! than the full Cell object.
+  extern std::vector<uint32_t> cell_rpn_offsets;
+  extern std::vector<int32_t> cell_rpn_tokens;
+
+  //! 16-bit copy of cell_rpn_tokens sharing the same offsets.  Surface
+  //! tokens almost never exceed 16 bits, and the narrower stream halves the
+  //! bytes the contains/distance loops pull through the cache.  Left empty
+  //! if any token is too large, in which case the 32-bit stream is used.
+  extern std::vector<int16_t> cell_rpn_tokens16;
+
+  //! Surface coefficients parallel to cell_rpn_tokens.  Operator tokens
+  //! occupy a slot marked generic so the two arrays share one set of offsets.
+  extern std::vector<SurfaceCoeffs> cell_rpn_coeffs;
+
+  //! Flattened per-instance cell temperatures.
+  //
+  //! The sqrt(kT) value for instance j of cell i is
+  //! `cell_sqrtkT[cell_sqrtkT_offsets[i] + j]`, so the collision-time
+  //! temperature lookup reads one contiguous array rather than each cell's
+  //! member vector.  The member vectors remain authoritative; see
+  //! flatten_cell_temperatures().
+  extern std::vector<uint32_t> cell_sqrtkT_offsets;
+  extern std::vector<double> cell_sqrtkT;
 } // namespace model
 
 //==============================================================================
@@ -81,6 +157,10 @@ public:
   Cell() {};
   virtual ~Cell() = default;
 
+  // Cells are movable (but not copyable) so they can be stored by value in
+  // the model::csg_cells/dag_cells arenas.
+  Cell(Cell&&) = default;
+
   //----------------------------------------------------------------------------
   // Methods
 
@@ -103,12 +183,15 @@ public:
   //! \param on_surface The signed index of a surface that the coordinate is
   //!   known to be on.  This index takes precedence over surface sense
   //!   calculations.
-  virtual bool
-  contains(Position r, Direction u, int32_t on_surface) const = 0;
+  //!
+  //! This function and distance are called millions of times per history, so
+  //! they dispatch on the kind_ tag rather than through the vtable; see the
+  //! inline definitions below the class definitions.
+  bool contains(Position r, Direction u, int32_t on_surface) const;
 
   //! Find the oncoming boundary of this cell.
-  virtual std::pair<double, int32_t>
-  distance(Position r, Direction u, int32_t on_surface) const = 0;
+  std::pair<double, int32_t>
+  distance(Position r, Direction u, int32_t on_surface) const;
 
   //! Write all information needed to reconstruct the cell to an HDF5 group.
   //! \param group_id An HDF5 group id.
@@ -133,6 +216,8 @@ public:
   // Data members
 
   int32_t id_;                //!< Unique ID
+  int32_t index_ {C_NONE};    //!< Index of this cell in model::cells
+  CellKind kind_ {CellKind::csg};  //!< Concrete type of this cell
   std::string name_;          //!< User-defined name
   int type_;                  //!< Material, universe, or lattice
   int32_t universe_;          //!< Universe # this cell is in
@@ -145,18 +230,18 @@ public:
   //! \brief Material(s) within this cell.
   //!
   //! May be multiple materials for distribcell.
-  std::vector<int32_t> material_;
+  SmallVector<int32_t, 1> material_;
 
   //! \brief Temperature(s) within this cell.
   //!
   //! The stored values are actually sqrt(k_Boltzmann * T) for each temperature
   //! T. The units are sqrt(eV).
-  std::vector<double> sqrtkT_;
+  SmallVector<double, 1> sqrtkT_;
 
   //! Definition of spatial region as Boolean expression of half-spaces
-  std::vector<std::int32_t> region_;
+  SmallVector<int32_t, 8> region_;
   //! Reverse Polish notation for region expression
-  std::vector<std::int32_t> rpn_;
+  SmallVector<int32_t, 8> rpn_;
   bool simple_;  //!< Does the region contain only intersections?
 
   //! \brief Neighboring cells in the same universe.
@@ -166,13 +251,15 @@ public:
 
   //! \brief Rotational tranfsormation of the filled universe.
   //
-  //! The vector is empty if there is no rotation.  Otherwise, the first three
-  //! values are the rotation angles respectively about the x-, y-, and z-, axes
-  //! in degrees.  The next 9 values give the rotation matrix in row-major
-  //! order.
-  std::vector<double> rotation_;
-
-  std::vector<int32_t> offset_;  //!< Distribcell offset table
+  //! Only valid if has_rotation_ is true.  The first three values are the
+  //! rotation angles respectively about the x-, y-, and z-, axes in degrees.
+  //! The next 9 values give the rotation matrix in row-major order.  A
+  //! fixed-size array keeps the matrix inline with the cell rather than
+  //! behind a heap indirection on every coordinate transform.
+  std::array<double, 12> rotation_;
+  bool has_rotation_ {false};
+
+  SmallVector<int32_t, 1> offset_;  //!< Distribcell offset table
 };
 
 //==============================================================================
@@ -185,10 +272,28 @@ public:
   explicit CSGCell(pugi::xml_node cell_node);
 
   bool
-  contains(Position r, Direction u, int32_t on_surface) const;
+  contains_impl(Position r, Direction u, int32_t on_surface) const;
+
+  //! \brief Determine which particles of a batch this cell contains.
+  //!
+  //! Evaluates the same region expression for up to 64 particles at once.
+  //! Each surface is fetched once per RPN token and its sense evaluated for
+  //! the whole batch, so the surface coefficients stay hot in cache and the
+  //! inner loop is a candidate for compiler vectorization.  Particles that
+  //! have already been rejected are skipped, which preserves the short
+  //! circuit behavior of contains_simple.
+  //! \param r Coordinates of the particles.
+  //! \param u Directions used to "break ties" for coordinates that are very
+  //!   close to a surface.
+  //! \param on_surface Signed surface indices that each particle is known to
+  //!   be on (or zero).
+  //! \param n Number of particles in the batch; must be no more than 64.
+  //! \param[out] out_mask Bit i is set if this cell contains particle i.
+  void contains_batch(const Position* r, const Direction* u,
+    const int32_t* on_surface, int n, uint64_t* out_mask) const;
 
   std::pair<double, int32_t>
-  distance(Position r, Direction u, int32_t on_surface) const;
+  distance_impl(Position r, Direction u, int32_t on_surface) const;
 
   void to_hdf5(hid_t group_id) const;
 
@@ -207,15 +312,63 @@ public:
   DAGCell();
   int32_t dag_index_;
 
-  bool contains(Position r, Direction u, int32_t on_surface) const;
+  bool contains_impl(Position r, Direction u, int32_t on_surface) const;
 
   std::pair<double, int32_t>
-  distance(Position r, Direction u, int32_t on_surface) const;
+  distance_impl(Position r, Direction u, int32_t on_surface) const;
 
   void to_hdf5(hid_t group_id) const;
 };
 #endif
 
+//==============================================================================
+// Cell arenas
+//==============================================================================
+
+namespace model {
+  //! Arenas that own the cell objects.
+  //
+  //! Storing the cells by value in creation order means a traversal over
+  //! neighboring cells streams sequential records instead of chasing
+  //! individually heap-allocated objects.  These vectors are reserved up
+  //! front from the input cell count; if they must grow later (C API), the
+  //! pointers in model::cells are remapped.
+  extern std::vector<CSGCell> csg_cells;
+#ifdef DAGMC
+  extern std::vector<DAGCell> dag_cells;
+#endif
+} // namespace model
+
+//==============================================================================
+// Cell inline dispatchers
+//
+// There are only two concrete cell types, so a test of the kind_ tag replaces
+// the virtual call.  This keeps the vtable pointer load and indirect branch
+// off the tracking hot path and lets the CSG case inline under LTO.
+//==============================================================================
+
+inline bool
+Cell::contains(Position r, Direction u, int32_t on_surface) const
+{
+#ifdef DAGMC
+  if (kind_ == CellKind::dag) {
+    return static_cast<const DAGCell*>(this)->contains_impl(r, u, on_surface);
+  }
+#endif
+  return static_cast<const CSGCell*>(this)->contains_impl(r, u, on_surface);
+}
+
+inline std::pair<double, int32_t>
+Cell::distance(Position r, Direction u, int32_t on_surface) const
+{
+#ifdef DAGMC
+  if (kind_ == CellKind::dag) {
+    return static_cast<const DAGCell*>(this)->distance_impl(r, u, on_surface);
+  }
+#endif
+  return static_cast<const CSGCell*>(this)->distance_impl(r, u, on_surface);
+}
+
 //==============================================================================
 //! Speeds up geometry searches by grouping cells in a search tree.
 //
@@ -227,23 +380,35 @@ public:
 class UniversePartitioner
 {
 public:
-  explicit UniversePartitioner(const Universe& univ);
+  //! Build the partitions for a universe.
+  //
+  //! Also reorders the universe's cell list so that cells sharing a partition
+  //! are adjacent, which improves locality for the linear scans in find_cell.
+  explicit UniversePartitioner(Universe& univ);
 
   //! Return the list of cells that could contain the given coordinates.
-  const std::vector<int32_t>& get_cells(Position r, Direction u) const;
+  gsl::span<const int32_t> get_cells(Position r, Direction u) const;
 
 private:
   //! A sorted vector of indices to surfaces that partition the universe
   std::vector<int32_t> surfs_;
 
-  //! Vectors listing the indices of the cells that lie within each partition
+  //! The z0_ values of the partitioning surfaces, in the same order as surfs_.
   //
-  //! There are n+1 partitions with n surfaces.  `partitions_.front()` gives the
-  //! cells that lie on the negative side of `surfs_.front()`.
-  //! `partitions_.back()` gives the cells that lie on the positive side of
-  //! `surfs_.back()`.  Otherwise, `partitions_[i]` gives cells sandwiched
-  //! between `surfs_[i-1]` and `surfs_[i]`.
-  std::vector<std::vector<int32_t>> partitions_;
+  //! Caching the plane coordinates here lets get_cells search a flat array of
+  //! doubles without a virtual sense() call per probe.
+  std::vector<double> surf_z_;
+
+  //! Indices of the cells that lie within each partition, flattened (CSR)
+  //
+  //! There are n+1 partitions with n surfaces.  The cells in partition i are
+  //! `partition_cells_[partition_offsets_[i]]` up to (but not including)
+  //! `partition_cells_[partition_offsets_[i+1]]`.  Partition 0 holds the cells
+  //! that lie on the negative side of `surfs_.front()` and partition n holds
+  //! the cells on the positive side of `surfs_.back()`.  Otherwise, partition
+  //! i holds cells sandwiched between `surfs_[i-1]` and `surfs_[i]`.
+  std::vector<uint32_t> partition_offsets_;
+  std::vector<int32_t> partition_cells_;
 };
 
 //==============================================================================
@@ -252,8 +417,27 @@ private:
 
 void read_cells(pugi::xml_node node);
 
+//! \brief Build the flattened RPN arrays in the model namespace.
+//
+//! Must be called after all cells have been read and their region
+//! specifications converted to RPN.  The member vectors on each Cell are kept
+//! as the authoritative copy for setup and HDF5 output; the flattened arrays
+//! are only read by the tracking loop.
+void flatten_cell_rpn();
+
+//! \brief Build the flattened temperature table in the model namespace.
+//
+//! Must be called after temperatures have been assigned to all cells.
+//! Cell::set_temperature keeps the table in sync afterwards.
+void flatten_cell_temperatures();
+
 #ifdef DAGMC
 int32_t next_cell(DAGCell* cur_cell, DAGSurface* surf_xed);
+
+//! Discard the cached (cell, surface) -> next cell lookups.  Must be called
+//! when the DAGMC model is freed so a reloaded geometry doesn't hit entries
+//! from the old one.
+void invalidate_next_cell_cache();
 #endif
 
 } // namespace openmc
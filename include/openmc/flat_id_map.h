@@ -0,0 +1,118 @@
+#ifndef OPENMC_FLAT_ID_MAP_H
+#define OPENMC_FLAT_ID_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace openmc {
+
+//==============================================================================
+//! An open-addressed hash table mapping user IDs to array indices.
+//
+//! std::unordered_map allocates a node per entry, so the ID lookups performed
+//! on every geometry search by user ID chase at least one pointer per probe.
+//! This table keeps its 8-byte key/value slots in a single contiguous,
+//! power-of-two sized array with linear probing, so a lookup typically
+//! touches one cache line.  Only the interface needed by the ID maps is
+//! provided: insertion via operator[], find, and clear.  Keys must be
+//! non-negative and erasure is not supported.
+//==============================================================================
+
+class FlatIdMap {
+public:
+  struct value_type {
+    int32_t first;   //!< User ID
+    int32_t second;  //!< Index in the corresponding array
+  };
+
+  FlatIdMap() { slots_.resize(std::size_t{1} << log2_capacity_, {EMPTY, 0}); }
+
+  //! Return a pointer to the entry for an ID, or end() if it is not present.
+  const value_type* find(int32_t key) const
+  {
+    // Negative keys would alias the EMPTY sentinel and falsely match an
+    // unoccupied slot; they are never valid IDs, so report them as absent.
+    if (key < 0) return nullptr;
+
+    std::size_t i = bucket(key);
+    while (true) {
+      const auto& slot = slots_[i];
+      if (slot.first == key) return &slot;
+      if (slot.first == EMPTY) return nullptr;
+      i = (i + 1) & (slots_.size() - 1);
+    }
+  }
+
+  //! Sentinel marking "not found"; named for std-container compatibility.
+  const value_type* end() const { return nullptr; }
+
+  //! Return a reference to the value for an ID, inserting it if necessary.
+  int32_t& operator[](int32_t key)
+  {
+    if (key < 0) {
+      throw std::runtime_error{"FlatIdMap keys must be non-negative."};
+    }
+
+    // Grow at 50% load so probe sequences stay short.
+    if (2 * (size_ + 1) > slots_.size()) grow();
+
+    std::size_t i = bucket(key);
+    while (true) {
+      auto& slot = slots_[i];
+      if (slot.first == key) return slot.second;
+      if (slot.first == EMPTY) {
+        slot.first = key;
+        slot.second = 0;
+        ++size_;
+        return slot.second;
+      }
+      i = (i + 1) & (slots_.size() - 1);
+    }
+  }
+
+  //! Preallocate capacity for at least n entries at 50% load.
+  void reserve(std::size_t n) { while (slots_.size() < 2 * n) grow(); }
+
+  void clear()
+  {
+    log2_capacity_ = 4;
+    slots_.assign(std::size_t{1} << log2_capacity_, {EMPTY, 0});
+    size_ = 0;
+  }
+
+  std::size_t size() const { return size_; }
+
+private:
+  static constexpr int32_t EMPTY {-1};
+
+  //! Map a key to a slot with Fibonacci hashing, which spreads the mostly
+  //! sequential user IDs across the table.
+  std::size_t bucket(int32_t key) const
+  {
+    return (static_cast<uint32_t>(key) * 2654435769u) >> (32 - log2_capacity_);
+  }
+
+  //! Double the capacity and rehash all occupied slots.
+  void grow()
+  {
+    std::vector<value_type> old;
+    old.swap(slots_);
+    ++log2_capacity_;
+    slots_.resize(std::size_t{1} << log2_capacity_, {EMPTY, 0});
+    for (const auto& slot : old) {
+      if (slot.first == EMPTY) continue;
+      std::size_t i = bucket(slot.first);
+      while (slots_[i].first != EMPTY) i = (i + 1) & (slots_.size() - 1);
+      slots_[i] = slot;
+    }
+  }
+
+  std::vector<value_type> slots_;
+  std::size_t size_ {0};
+  int log2_capacity_ {4};
+};
+
+} // namespace openmc
+#endif // OPENMC_FLAT_ID_MAP_H
@@ -24,6 +24,14 @@ public:
   using value_type = int32_t;
   using const_iterator = std::forward_list<value_type>::const_iterator;
 
+  NeighborList() = default;
+
+  // The mutex itself cannot be moved, so a moved-from list hands over its
+  // elements and the destination keeps its own freshly-constructed mutex.
+  // Moves only happen at setup time when the containers that own cells grow,
+  // so no other thread can hold the lock.
+  NeighborList(NeighborList&& other) : list_(std::move(other.list_)) {}
+
   // Attempt to add an element.
   //
   // If the relevant OpenMP lock is currently owned by another thread, this
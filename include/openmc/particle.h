@@ -41,7 +41,7 @@ constexpr double CACHE_INVALID {-1.0};
 
 class LocalCoord {
 public:
-  void rotate(const std::vector<double>& rotation);
+  void rotate(const std::array<double, 12>& rotation);
 
   //! clear data from a single coordinate level
   void reset();
@@ -64,7 +64,7 @@ struct Position {
   }
 
   //! Rotate the position based on a rotation matrix
-  Position rotate(const std::vector<double>& rotation) const;
+  Position rotate(const std::array<double, 12>& rotation) const;
 
   // Data members
   double x = 0.;
@@ -0,0 +1,182 @@
+#ifndef OPENMC_SMALL_VECTOR_H
+#define OPENMC_SMALL_VECTOR_H
+
+#include <cstddef>
+#include <cstring>  // for memcpy
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace openmc {
+
+//==============================================================================
+//! A dynamic array with a small-buffer optimization.
+//
+//! A std::vector always places its elements on the heap, so every small
+//! per-cell array (materials, temperatures, RPN tokens, ...) costs a separate
+//! allocation at setup time and an extra indirection whenever it is read.
+//! This container stores up to N elements inline in the object itself and
+//! only falls back to the heap beyond that, which keeps short arrays on the
+//! same cache lines as the object that owns them.
+//
+//! Only the subset of the std::vector interface used by the cell data members
+//! is implemented, and the element type is restricted to trivially copyable
+//! types so elements can be moved with memcpy.
+//==============================================================================
+
+template<typename T, std::size_t N>
+class SmallVector {
+  static_assert(std::is_trivially_copyable<T>::value,
+    "SmallVector only supports trivially copyable element types.");
+
+public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  SmallVector() = default;
+
+  SmallVector(const SmallVector& other) { *this = other; }
+
+  SmallVector(SmallVector&& other) { *this = std::move(other); }
+
+  SmallVector(const std::vector<T>& other) { *this = other; }
+
+  ~SmallVector()
+  {
+    if (data_ != inline_) delete[] data_;
+  }
+
+  SmallVector& operator=(const SmallVector& other)
+  {
+    if (this != &other) assign_range(other.data_, other.size_);
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other)
+  {
+    if (this != &other) {
+      if (other.data_ != other.inline_) {
+        // Steal the heap buffer.
+        if (data_ != inline_) delete[] data_;
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = other.inline_;
+        other.size_ = 0;
+        other.capacity_ = N;
+      } else {
+        assign_range(other.data_, other.size_);
+      }
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(const std::vector<T>& other)
+  {
+    assign_range(other.data(), other.size());
+    return *this;
+  }
+
+  //----------------------------------------------------------------------------
+  // Element access
+
+  T& operator[](std::size_t i) { return data_[i]; }
+  const T& operator[](std::size_t i) const { return data_[i]; }
+
+  T& at(std::size_t i)
+  {
+    if (i >= size_) throw std::out_of_range{"Index in SmallVector is out of "
+      "bounds."};
+    return data_[i];
+  }
+
+  const T& at(std::size_t i) const
+  {
+    if (i >= size_) throw std::out_of_range{"Index in SmallVector is out of "
+      "bounds."};
+    return data_[i];
+  }
+
+  T& front() { return data_[0]; }
+  const T& front() const { return data_[0]; }
+  T& back() { return data_[size_ - 1]; }
+  const T& back() const { return data_[size_ - 1]; }
+
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+
+  //----------------------------------------------------------------------------
+  // Iterators
+
+  iterator begin() { return data_; }
+  const_iterator begin() const { return data_; }
+  const_iterator cbegin() const { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator end() const { return data_ + size_; }
+  const_iterator cend() const { return data_ + size_; }
+
+  //----------------------------------------------------------------------------
+  // Capacity and modifiers
+
+  bool empty() const { return size_ == 0; }
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return capacity_; }
+
+  void reserve(std::size_t n)
+  {
+    if (n > capacity_) reallocate(n);
+  }
+
+  //! No-op: the inline buffer cannot be released.
+  void shrink_to_fit() {}
+
+  void clear() { size_ = 0; }
+
+  void push_back(const T& value)
+  {
+    if (size_ == capacity_) reallocate(2 * capacity_);
+    data_[size_++] = value;
+  }
+
+  template<typename... Args>
+  void emplace_back(Args&&... args)
+  {
+    push_back(T(std::forward<Args>(args)...));
+  }
+
+  void pop_back() { --size_; }
+
+  void resize(std::size_t n, const T& value = T())
+  {
+    reserve(n);
+    for (std::size_t i = size_; i < n; ++i) data_[i] = value;
+    size_ = n;
+  }
+
+private:
+  void assign_range(const T* values, std::size_t n)
+  {
+    size_ = 0;
+    reserve(n);
+    if (n > 0) std::memcpy(data_, values, n * sizeof(T));
+    size_ = n;
+  }
+
+  void reallocate(std::size_t n)
+  {
+    T* buffer = new T[n];
+    if (size_ > 0) std::memcpy(buffer, data_, size_ * sizeof(T));
+    if (data_ != inline_) delete[] data_;
+    data_ = buffer;
+    capacity_ = n;
+  }
+
+  T inline_[N];
+  T* data_ {inline_};
+  std::size_t size_ {0};
+  std::size_t capacity_ {N};
+};
+
+} // namespace openmc
+#endif // OPENMC_SMALL_VECTOR_H
@@ -1,6 +1,7 @@
 #ifndef OPENMC_TALLIES_FILTER_PARTICLE_H
 #define OPENMC_TALLIES_FILTER_PARTICLE_H
 
+#include <array>
 #include <vector>
 
 #include "openmc/particle.h"
@@ -46,6 +47,12 @@ private:
   // Data members
 
   std::vector<Particle::Type> particles_;
+
+  //! Map from particle type to the bin for that type, or -1 if the type is
+  //! not binned.  Only used when no type appears in more than one bin, which
+  //! lets get_all_bins skip the scan over particles_.
+  std::array<int8_t, 4> bin_of_type_;
+  bool duplicate_bins_ {false};
 };
 
 } // namespace openmc
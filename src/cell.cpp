@@ -5,6 +5,7 @@
 #include <sstream>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <cctype>
 
 #include "openmc/capi.h"
@@ -26,13 +27,196 @@ namespace openmc {
 //==============================================================================
 
 namespace model {
-  std::vector<std::unique_ptr<Cell>> cells;
-  std::unordered_map<int32_t, int32_t> cell_map;
+  std::vector<Cell*> cells;
+  std::vector<CSGCell> csg_cells;
+#ifdef DAGMC
+  std::vector<DAGCell> dag_cells;
+#endif
+  FlatIdMap cell_map;
 
   std::vector<std::unique_ptr<Universe>> universes;
-  std::unordered_map<int32_t, int32_t> universe_map;
+  FlatIdMap universe_map;
+
+  std::vector<uint32_t> cell_rpn_offsets;
+  std::vector<int32_t> cell_rpn_tokens;
+  std::vector<int16_t> cell_rpn_tokens16;
+  std::vector<SurfaceCoeffs> cell_rpn_coeffs;
+  std::vector<uint32_t> cell_sqrtkT_offsets;
+  std::vector<double> cell_sqrtkT;
 } // namespace model
 
+//==============================================================================
+//! Return the RPN token stream for a cell.
+//!
+//! The flattened model arrays are preferred since they pack the streams for
+//! all cells contiguously.  Cells created after flatten_cell_rpn() was called
+//! (e.g. through the C API) fall back to their member vector.
+//==============================================================================
+
+namespace {
+
+inline const int32_t*
+rpn_tokens(const Cell& c, size_t* n)
+{
+  if (c.index_ >= 0
+      && c.index_ + 1 < static_cast<int64_t>(model::cell_rpn_offsets.size())) {
+    auto start = model::cell_rpn_offsets[c.index_];
+    *n = model::cell_rpn_offsets[c.index_ + 1] - start;
+    return model::cell_rpn_tokens.data() + start;
+  }
+  *n = c.rpn_.size();
+  return c.rpn_.data();
+}
+
+//! Return the 16-bit packed RPN stream for a cell, or nullptr if the tokens
+//! didn't fit in 16 bits or the flattened arrays don't cover this cell.
+inline const int16_t*
+rpn_tokens16(const Cell& c, size_t* n)
+{
+  if (c.index_ >= 0 && !model::cell_rpn_tokens16.empty()
+      && c.index_ + 1 < static_cast<int64_t>(model::cell_rpn_offsets.size())) {
+    auto start = model::cell_rpn_offsets[c.index_];
+    *n = model::cell_rpn_offsets[c.index_ + 1] - start;
+    return model::cell_rpn_tokens16.data() + start;
+  }
+  return nullptr;
+}
+
+//! Maps a token type to its operator constants so the contains/distance
+//! loops below can be written once and instantiated for either stream width.
+template<typename T> struct RpnOps;
+
+template<> struct RpnOps<int32_t> {
+  static constexpr int32_t UNION = OP_UNION;
+  static constexpr int32_t INTERSECTION = OP_INTERSECTION;
+  static constexpr int32_t COMPLEMENT = OP_COMPLEMENT;
+};
+
+template<> struct RpnOps<int16_t> {
+  static constexpr int16_t UNION = OP16_UNION;
+  static constexpr int16_t INTERSECTION = OP16_INTERSECTION;
+  static constexpr int16_t COMPLEMENT = OP16_COMPLEMENT;
+};
+
+//! Return the coefficient table parallel to a cell's flattened RPN stream, or
+//! nullptr if the flattened arrays don't cover this cell.
+inline const SurfaceCoeffs*
+rpn_coeffs(const Cell& c)
+{
+  if (c.index_ >= 0
+      && c.index_ + 1 < static_cast<int64_t>(model::cell_rpn_offsets.size())) {
+    return model::cell_rpn_coeffs.data() + model::cell_rpn_offsets[c.index_];
+  }
+  return nullptr;
+}
+
+//! Extract the defining coefficients of a surface for inline sense
+//! evaluation.  Types not handled here are left marked generic.
+SurfaceCoeffs
+surface_coeffs(const Surface& surf)
+{
+  using Kind = SurfaceCoeffs::Kind;
+  SurfaceCoeffs sc {};
+
+  if (const auto* s = dynamic_cast<const SurfaceXPlane*>(&surf)) {
+    sc.kind = Kind::x_plane;
+    sc.d = s->x0_;
+  } else if (const auto* s = dynamic_cast<const SurfaceYPlane*>(&surf)) {
+    sc.kind = Kind::y_plane;
+    sc.d = s->y0_;
+  } else if (const auto* s = dynamic_cast<const SurfaceZPlane*>(&surf)) {
+    sc.kind = Kind::z_plane;
+    sc.d = s->z0_;
+  } else if (const auto* s = dynamic_cast<const SurfacePlane*>(&surf)) {
+    sc.kind = Kind::plane;
+    sc.a = s->A_;
+    sc.b = s->B_;
+    sc.c = s->C_;
+    sc.d = s->D_;
+  } else if (const auto* s = dynamic_cast<const SurfaceSphere*>(&surf)) {
+    sc.kind = Kind::sphere;
+    sc.a = s->x0_;
+    sc.b = s->y0_;
+    sc.c = s->z0_;
+    sc.d = s->radius_ * s->radius_;
+  } else if (const auto* s = dynamic_cast<const SurfaceXCylinder*>(&surf)) {
+    sc.kind = Kind::x_cylinder;
+    sc.b = s->y0_;
+    sc.c = s->z0_;
+    sc.d = s->radius_ * s->radius_;
+  } else if (const auto* s = dynamic_cast<const SurfaceYCylinder*>(&surf)) {
+    sc.kind = Kind::y_cylinder;
+    sc.a = s->x0_;
+    sc.c = s->z0_;
+    sc.d = s->radius_ * s->radius_;
+  } else if (const auto* s = dynamic_cast<const SurfaceZCylinder*>(&surf)) {
+    sc.kind = Kind::z_cylinder;
+    sc.a = s->x0_;
+    sc.b = s->y0_;
+    sc.d = s->radius_ * s->radius_;
+  }
+
+  return sc;
+}
+
+//! Evaluate the sense of a point with respect to a surface, using the cached
+//! coefficients when possible.  Matches Surface::sense, including the
+//! direction-based tie break for near-coincident points (which needs the
+//! surface normal and so defers to the virtual interface).
+inline bool
+coeff_sense(const SurfaceCoeffs& sc, const Surface& surf, Position r,
+            Direction u)
+{
+  using Kind = SurfaceCoeffs::Kind;
+  double f;
+  switch (sc.kind) {
+  case Kind::x_plane:
+    f = r.x - sc.d;
+    break;
+  case Kind::y_plane:
+    f = r.y - sc.d;
+    break;
+  case Kind::z_plane:
+    f = r.z - sc.d;
+    break;
+  case Kind::plane:
+    f = sc.a*r.x + sc.b*r.y + sc.c*r.z - sc.d;
+    break;
+  case Kind::sphere: {
+    double x = r.x - sc.a;
+    double y = r.y - sc.b;
+    double z = r.z - sc.c;
+    f = x*x + y*y + z*z - sc.d;
+    break;
+  }
+  case Kind::x_cylinder: {
+    double y = r.y - sc.b;
+    double z = r.z - sc.c;
+    f = y*y + z*z - sc.d;
+    break;
+  }
+  case Kind::y_cylinder: {
+    double x = r.x - sc.a;
+    double z = r.z - sc.c;
+    f = x*x + z*z - sc.d;
+    break;
+  }
+  case Kind::z_cylinder: {
+    double x = r.x - sc.a;
+    double y = r.y - sc.b;
+    f = x*x + y*y - sc.d;
+    break;
+  }
+  default:
+    return surf.sense(r, u);
+  }
+
+  if (std::abs(f) < FP_COINCIDENT) return surf.sense(r, u);
+  return f > 0.0;
+}
+
+} // anonymous namespace
+
 //==============================================================================
 //! Convert region specification string to integer tokens.
 //!
@@ -109,7 +293,7 @@ tokenize(const std::string region_spec) {
 //==============================================================================
 
 std::vector<int32_t>
-generate_rpn(int32_t cell_id, std::vector<int32_t> infix)
+generate_rpn(int32_t cell_id, gsl::span<const int32_t> infix)
 {
   std::vector<int32_t> rpn;
   std::vector<int32_t> stack;
@@ -239,6 +423,15 @@ Cell::set_temperature(double T, int32_t instance)
       T_ = std::sqrt(K_BOLTZMANN * T);
     }
   }
+
+  // Keep the flattened temperature table in sync if it has been built.
+  if (index_ >= 0
+      && index_ + 1 < static_cast<int64_t>(model::cell_sqrtkT_offsets.size())) {
+    auto start = model::cell_sqrtkT_offsets[index_];
+    for (size_t i = 0; i < sqrtkT_.size(); ++i) {
+      model::cell_sqrtkT[start + i] = sqrtkT_[i];
+    }
+  }
 }
 
 //==============================================================================
@@ -422,35 +615,35 @@ CSGCell::CSGCell(pugi::xml_node cell_node)
     }
 
     // Store the rotation angles.
-    rotation_.reserve(12);
-    rotation_.push_back(rot[0]);
-    rotation_.push_back(rot[1]);
-    rotation_.push_back(rot[2]);
+    has_rotation_ = true;
+    rotation_[0] = rot[0];
+    rotation_[1] = rot[1];
+    rotation_[2] = rot[2];
 
     // Compute and store the rotation matrix.
     auto phi = -rot[0] * PI / 180.0;
     auto theta = -rot[1] * PI / 180.0;
     auto psi = -rot[2] * PI / 180.0;
-    rotation_.push_back(std::cos(theta) * std::cos(psi));
-    rotation_.push_back(-std::cos(phi) * std::sin(psi)
-                        + std::sin(phi) * std::sin(theta) * std::cos(psi));
-    rotation_.push_back(std::sin(phi) * std::sin(psi)
-                        + std::cos(phi) * std::sin(theta) * std::cos(psi));
-    rotation_.push_back(std::cos(theta) * std::sin(psi));
-    rotation_.push_back(std::cos(phi) * std::cos(psi)
-                        + std::sin(phi) * std::sin(theta) * std::sin(psi));
-    rotation_.push_back(-std::sin(phi) * std::cos(psi)
-                        + std::cos(phi) * std::sin(theta) * std::sin(psi));
-    rotation_.push_back(-std::sin(theta));
-    rotation_.push_back(std::sin(phi) * std::cos(theta));
-    rotation_.push_back(std::cos(phi) * std::cos(theta));
+    rotation_[3] = std::cos(theta) * std::cos(psi);
+    rotation_[4] = -std::cos(phi) * std::sin(psi)
+                   + std::sin(phi) * std::sin(theta) * std::cos(psi);
+    rotation_[5] = std::sin(phi) * std::sin(psi)
+                   + std::cos(phi) * std::sin(theta) * std::cos(psi);
+    rotation_[6] = std::cos(theta) * std::sin(psi);
+    rotation_[7] = std::cos(phi) * std::cos(psi)
+                   + std::sin(phi) * std::sin(theta) * std::sin(psi);
+    rotation_[8] = -std::sin(phi) * std::cos(psi)
+                   + std::cos(phi) * std::sin(theta) * std::sin(psi);
+    rotation_[9] = -std::sin(theta);
+    rotation_[10] = std::sin(phi) * std::cos(theta);
+    rotation_[11] = std::cos(phi) * std::cos(theta);
   }
 }
 
 //==============================================================================
 
 bool
-CSGCell::contains(Position r, Direction u, int32_t on_surface) const
+CSGCell::contains_impl(Position r, Direction u, int32_t on_surface) const
 {
   if (simple_) {
     return contains_simple(r, u, on_surface);
@@ -460,16 +653,161 @@ CSGCell::contains(Position r, Direction u, int32_t on_surface) const
 }
 
 //==============================================================================
+// The contains/distance loops below are templated on the token type so that
+// they can walk either the 32-bit or the packed 16-bit RPN stream; the
+// member functions pick whichever stream is available for the cell.
+//==============================================================================
+
+namespace {
+
+template<typename T>
+bool
+contains_simple_impl(const T* tokens, size_t n, const SurfaceCoeffs* coeffs,
+                     Position r, Direction u, int32_t on_surface)
+{
+  for (size_t i = 0; i < n; ++i) {
+    int32_t token = tokens[i];
+    // Assume that no tokens are operators. Evaluate the sense of particle with
+    // respect to the surface and see if the token matches the sense. If the
+    // particle's surface attribute is set and matches the token, that
+    // overrides the determination based on sense().
+    if (token == on_surface) {
+    } else if (-token == on_surface) {
+      return false;
+    } else {
+      // Note the off-by-one indexing
+      const auto& surf = *model::surfaces[abs(token)-1];
+      bool sense = coeffs ? coeff_sense(coeffs[i], surf, r, u)
+                          : surf.sense(r, u);
+      if (sense != (token > 0)) {return false;}
+    }
+  }
+  return true;
+}
+
+//! Fallback for region expressions deeper than the 64-bit stack used in
+//! contains_complex_impl.
+template<typename T>
+bool
+contains_complex_big_impl(const T* tokens, size_t n, Position r, Direction u,
+                          int32_t on_surface)
+{
+  // Reuse a thread-local scratch buffer so that deep expressions, which hit
+  // this fallback on every particle step, don't go through the global
+  // allocator each time.  The buffer only grows; it holds one byte per token
+  // and there is one per thread, so the footprint stays trivial.
+  static thread_local std::vector<uint8_t> stack;
+  if (stack.size() < n) stack.resize(n);
+  int i_stack = -1;
+
+  for (size_t i = 0; i < n; ++i) {
+    T token = tokens[i];
+    if (token == RpnOps<T>::UNION) {
+      stack[i_stack-1] = stack[i_stack-1] || stack[i_stack];
+      i_stack --;
+    } else if (token == RpnOps<T>::INTERSECTION) {
+      stack[i_stack-1] = stack[i_stack-1] && stack[i_stack];
+      i_stack --;
+    } else if (token == RpnOps<T>::COMPLEMENT) {
+      stack[i_stack] = !stack[i_stack];
+    } else {
+      i_stack ++;
+      if (token == on_surface) {
+        stack[i_stack] = true;
+      } else if (-token == on_surface) {
+        stack[i_stack] = false;
+      } else {
+        // Note the off-by-one indexing
+        bool sense = model::surfaces[abs(token)-1]->sense(r, u);
+        stack[i_stack] = (sense == (token > 0));
+      }
+    }
+  }
+
+  if (i_stack == 0) {
+    return stack[i_stack];
+  } else {
+    // This case occurs if there is no region specification since i_stack will
+    // still be -1.
+    return true;
+  }
+}
+
+template<typename T>
+bool
+contains_complex_impl(const T* tokens, size_t n, Position r, Direction u,
+                      int32_t on_surface)
+{
+  // An expression with more tokens than bits in the stack word is exceedingly
+  // unlikely, but fall back to a heap-allocated stack just in case.
+  if (n > 64) return contains_complex_big_impl(tokens, n, r, u, on_surface);
+
+  // Make a stack of booleans where each half-space result occupies a single
+  // bit of a machine word.  rpn.size() is an upper bound on the stack depth,
+  // so 64 bits suffice for any reasonable region, the operators reduce to
+  // branch-free bitwise arithmetic, and the whole stack can live in a
+  // register.
+  uint64_t stack = 0;
+  int i_stack = -1;
+
+  for (size_t i = 0; i < n; ++i) {
+    T token = tokens[i];
+    // If the token is a binary operator (intersection/union), apply it to
+    // the last two items on the stack. If the token is a unary operator
+    // (complement), apply it to the last item on the stack.
+    if (token == RpnOps<T>::UNION) {
+      uint64_t bit = ((stack >> (i_stack-1)) | (stack >> i_stack)) & 1;
+      i_stack --;
+      stack = (stack & ~(uint64_t{1} << i_stack)) | (bit << i_stack);
+    } else if (token == RpnOps<T>::INTERSECTION) {
+      uint64_t bit = ((stack >> (i_stack-1)) & (stack >> i_stack)) & 1;
+      i_stack --;
+      stack = (stack & ~(uint64_t{1} << i_stack)) | (bit << i_stack);
+    } else if (token == RpnOps<T>::COMPLEMENT) {
+      stack ^= uint64_t{1} << i_stack;
+    } else {
+      // If the token is not an operator, evaluate the sense of particle with
+      // respect to the surface and see if the token matches the sense. If the
+      // particle's surface attribute is set and matches the token, that
+      // overrides the determination based on sense().
+      uint64_t bit;
+      if (token == on_surface) {
+        bit = 1;
+      } else if (-token == on_surface) {
+        bit = 0;
+      } else {
+        // Note the off-by-one indexing
+        bool sense = model::surfaces[abs(token)-1]->sense(r, u);
+        bit = (sense == (token > 0));
+      }
+      i_stack ++;
+      stack = (stack & ~(uint64_t{1} << i_stack)) | (bit << i_stack);
+    }
+  }
 
+  if (i_stack == 0) {
+    // The one remaining bit on the stack indicates whether the particle is
+    // in the cell.
+    return stack & 1;
+  } else {
+    // This case occurs if there is no region specification since i_stack will
+    // still be -1.
+    return true;
+  }
+}
+
+template<typename T>
 std::pair<double, int32_t>
-CSGCell::distance(Position r, Direction u, int32_t on_surface) const
+distance_rpn_impl(const T* tokens, size_t n, Position r, Direction u,
+                  int32_t on_surface)
 {
   double min_dist {INFTY};
   int32_t i_surf {std::numeric_limits<int32_t>::max()};
 
-  for (int32_t token : rpn_) {
+  for (size_t i = 0; i < n; ++i) {
+    int32_t token = tokens[i];
     // Ignore this token if it corresponds to an operator rather than a region.
-    if (token >= OP_UNION) continue;
+    if (tokens[i] >= RpnOps<T>::UNION) continue;
 
     // Calculate the distance to this surface.
     // Note the off-by-one indexing
@@ -488,6 +826,120 @@ CSGCell::distance(Position r, Direction u, int32_t on_surface) const
   return {min_dist, i_surf};
 }
 
+template<typename T>
+uint64_t
+contains_batch_impl(const T* tokens, size_t n_token,
+  const SurfaceCoeffs* coeffs, const Position* r, const Direction* u,
+  const int32_t* on_surface, int n, uint64_t mask)
+{
+  for (size_t i_token = 0; i_token < n_token && mask; ++i_token) {
+    int32_t token = tokens[i_token];
+
+    // Fetch the surface once for the whole batch.  Note the off-by-one
+    // indexing.
+    const auto& surf = *model::surfaces[abs(token)-1];
+
+    for (int i = 0; i < n; ++i) {
+      uint64_t bit = uint64_t{1} << i;
+      if (!(mask & bit)) continue;
+
+      // As in contains_simple, a particle's surface attribute takes
+      // precedence over the sense calculation.
+      if (token == on_surface[i]) {
+      } else if (-token == on_surface[i]) {
+        mask &= ~bit;
+      } else {
+        bool sense = coeffs ? coeff_sense(coeffs[i_token], surf, r[i], u[i])
+                            : surf.sense(r[i], u[i]);
+        if (sense != (token > 0)) mask &= ~bit;
+      }
+    }
+  }
+  return mask;
+}
+
+// Runtime CPU dispatch for the batched kernel.  target_clones has the
+// compiler emit baseline, AVX2, and AVX-512 versions of these wrappers (the
+// templated body above is inlined into each clone) and select one at load
+// time through an ifunc resolver, so wider vector units get used where
+// available without baking AVX into the whole build.  Restricted to GCC on
+// x86-64 ELF targets, which is where ifunc support is reliable; everywhere
+// else these compile to plain calls.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) \
+    && defined(__ELF__)
+#define OPENMC_BATCH_CLONES \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define OPENMC_BATCH_CLONES
+#endif
+
+OPENMC_BATCH_CLONES uint64_t
+contains_batch_run(const int16_t* tokens, size_t n_token,
+  const SurfaceCoeffs* coeffs, const Position* r, const Direction* u,
+  const int32_t* on_surface, int n, uint64_t mask)
+{
+  return contains_batch_impl(tokens, n_token, coeffs, r, u, on_surface, n,
+    mask);
+}
+
+OPENMC_BATCH_CLONES uint64_t
+contains_batch_run(const int32_t* tokens, size_t n_token,
+  const SurfaceCoeffs* coeffs, const Position* r, const Direction* u,
+  const int32_t* on_surface, int n, uint64_t mask)
+{
+  return contains_batch_impl(tokens, n_token, coeffs, r, u, on_surface, n,
+    mask);
+}
+
+} // namespace
+
+//==============================================================================
+
+void
+CSGCell::contains_batch(const Position* r, const Direction* u,
+  const int32_t* on_surface, int n, uint64_t* out_mask) const
+{
+  // Complex cells require a per-particle stack evaluation, so fall back to
+  // the scalar routine for those.
+  if (!simple_) {
+    uint64_t mask = 0;
+    for (int i = 0; i < n; ++i) {
+      if (contains_complex(r[i], u[i], on_surface[i])) {
+        mask |= uint64_t{1} << i;
+      }
+    }
+    *out_mask = mask;
+    return;
+  }
+
+  // Start with all particles inside and clear bits as half-space checks fail.
+  uint64_t mask = (n < 64) ? (uint64_t{1} << n) - 1 : ~uint64_t{0};
+
+  size_t n_token;
+  const SurfaceCoeffs* coeffs = rpn_coeffs(*this);
+  if (const int16_t* t16 = rpn_tokens16(*this, &n_token)) {
+    *out_mask = contains_batch_run(t16, n_token, coeffs, r, u, on_surface,
+      n, mask);
+    return;
+  }
+  const int32_t* tokens = rpn_tokens(*this, &n_token);
+  *out_mask = contains_batch_run(tokens, n_token, coeffs, r, u, on_surface,
+    n, mask);
+}
+
+//==============================================================================
+
+std::pair<double, int32_t>
+CSGCell::distance_impl(Position r, Direction u, int32_t on_surface) const
+{
+  size_t n;
+  if (const int16_t* t16 = rpn_tokens16(*this, &n)) {
+    return distance_rpn_impl(t16, n, r, u, on_surface);
+  }
+  const int32_t* tokens = rpn_tokens(*this, &n);
+  return distance_rpn_impl(tokens, n, r, u, on_surface);
+}
+
 //==============================================================================
 
 void
@@ -554,7 +1006,7 @@ CSGCell::to_hdf5(hid_t cell_group) const
     if (translation_ != Position(0, 0, 0)) {
       write_dataset(group, "translation", translation_);
     }
-    if (!rotation_.empty()) {
+    if (has_rotation_) {
       std::array<double, 3> rot {rotation_[0], rotation_[1], rotation_[2]};
       write_dataset(group, "rotation", rot);
     }
@@ -572,21 +1024,13 @@ CSGCell::to_hdf5(hid_t cell_group) const
 bool
 CSGCell::contains_simple(Position r, Direction u, int32_t on_surface) const
 {
-  for (int32_t token : rpn_) {
-    // Assume that no tokens are operators. Evaluate the sense of particle with
-    // respect to the surface and see if the token matches the sense. If the
-    // particle's surface attribute is set and matches the token, that
-    // overrides the determination based on sense().
-    if (token == on_surface) {
-    } else if (-token == on_surface) {
-      return false;
-    } else {
-      // Note the off-by-one indexing
-      bool sense = model::surfaces[abs(token)-1]->sense(r, u);
-      if (sense != (token > 0)) {return false;}
-    }
+  size_t n;
+  const SurfaceCoeffs* coeffs = rpn_coeffs(*this);
+  if (const int16_t* t16 = rpn_tokens16(*this, &n)) {
+    return contains_simple_impl(t16, n, coeffs, r, u, on_surface);
   }
-  return true;
+  const int32_t* tokens = rpn_tokens(*this, &n);
+  return contains_simple_impl(tokens, n, coeffs, r, u, on_surface);
 }
 
 //==============================================================================
@@ -594,60 +1038,22 @@ CSGCell::contains_simple(Position r, Direction u, int32_t on_surface) const
 bool
 CSGCell::contains_complex(Position r, Direction u, int32_t on_surface) const
 {
-  // Make a stack of booleans.  We don't know how big it needs to be, but we do
-  // know that rpn.size() is an upper-bound.
-  std::vector<bool> stack(rpn_.size());
-  int i_stack = -1;
-
-  for (int32_t token : rpn_) {
-    // If the token is a binary operator (intersection/union), apply it to
-    // the last two items on the stack. If the token is a unary operator
-    // (complement), apply it to the last item on the stack.
-    if (token == OP_UNION) {
-      stack[i_stack-1] = stack[i_stack-1] || stack[i_stack];
-      i_stack --;
-    } else if (token == OP_INTERSECTION) {
-      stack[i_stack-1] = stack[i_stack-1] && stack[i_stack];
-      i_stack --;
-    } else if (token == OP_COMPLEMENT) {
-      stack[i_stack] = !stack[i_stack];
-    } else {
-      // If the token is not an operator, evaluate the sense of particle with
-      // respect to the surface and see if the token matches the sense. If the
-      // particle's surface attribute is set and matches the token, that
-      // overrides the determination based on sense().
-      i_stack ++;
-      if (token == on_surface) {
-        stack[i_stack] = true;
-      } else if (-token == on_surface) {
-        stack[i_stack] = false;
-      } else {
-        // Note the off-by-one indexing
-        bool sense = model::surfaces[abs(token)-1]->sense(r, u);
-        stack[i_stack] = (sense == (token > 0));
-      }
-    }
-  }
-
-  if (i_stack == 0) {
-    // The one remaining bool on the stack indicates whether the particle is
-    // in the cell.
-    return stack[i_stack];
-  } else {
-    // This case occurs if there is no region specification since i_stack will
-    // still be -1.
-    return true;
+  size_t n;
+  if (const int16_t* t16 = rpn_tokens16(*this, &n)) {
+    return contains_complex_impl(t16, n, r, u, on_surface);
   }
+  const int32_t* tokens = rpn_tokens(*this, &n);
+  return contains_complex_impl(tokens, n, r, u, on_surface);
 }
 
 //==============================================================================
 // DAGMC Cell implementation
 //==============================================================================
 #ifdef DAGMC
-DAGCell::DAGCell() : Cell{} {};
+DAGCell::DAGCell() : Cell{} { kind_ = CellKind::dag; };
 
 std::pair<double, int32_t>
-DAGCell::distance(Position r, Direction u, int32_t on_surface) const
+DAGCell::distance_impl(Position r, Direction u, int32_t on_surface) const
 {
   // if we've changed direction or we're not on a surface,
   // reset the history and update last direction
@@ -676,7 +1082,7 @@ DAGCell::distance(Position r, Direction u, int32_t on_surface) const
   return {dist, surf_idx};
 }
 
-bool DAGCell::contains(Position r, Direction u, int32_t on_surface) const
+bool DAGCell::contains_impl(Position r, Direction u, int32_t on_surface) const
 {
   moab::ErrorCode rval;
   moab::EntityHandle vol = dagmc_ptr_->entity_by_index(3, dag_index_);
@@ -697,7 +1103,7 @@ void DAGCell::to_hdf5(hid_t group_id) const { return; }
 // UniversePartitioner implementation
 //==============================================================================
 
-UniversePartitioner::UniversePartitioner(const Universe& univ)
+UniversePartitioner::UniversePartitioner(Universe& univ)
 {
   // Define an ordered set of surface indices that point to z-planes.  Use a
   // functor to to order the set by the z0_ values of the corresponding planes.
@@ -728,16 +1134,29 @@ UniversePartitioner::UniversePartitioner(const Universe& univ)
     }
   }
 
-  // Populate the surfs_ vector from the ordered set.
+  // Populate the surfs_ vector from the ordered set and cache the z0_ values
+  // of the planes so the search in get_cells doesn't need virtual calls.
   surfs_.insert(surfs_.begin(), surf_set.begin(), surf_set.end());
+  surf_z_.reserve(surfs_.size());
+  for (auto i_surf : surfs_) {
+    const auto* zplane
+      = dynamic_cast<const SurfaceZPlane*>(model::surfaces[i_surf].get());
+    surf_z_.push_back(zplane->z0_);
+  }
 
-  // Populate the partition lists.
-  partitions_.resize(surfs_.size() + 1);
-  for (auto i_cell : univ.cells_) {
-    // It is difficult to determine the bounds of a complex cell, so add complex
-    // cells to all partitions.
+  // Determine the partition range covered by each cell.  The cells are
+  // independent of one another, so this loop runs in parallel for large
+  // reactor-style universes; the serial fill below keeps the partition lists
+  // in the same deterministic order as a serial build.
+  std::vector<std::pair<int, int>> ranges(univ.cells_.size());
+  #pragma omp parallel for schedule(static)
+  for (int64_t k = 0; k < static_cast<int64_t>(univ.cells_.size()); ++k) {
+    auto i_cell = univ.cells_[k];
+
+    // It is difficult to determine the bounds of a complex cell, so add
+    // complex cells to all partitions.
     if (!model::cells[i_cell]->simple_) {
-      for (auto& p : partitions_) p.push_back(i_cell);
+      ranges[k] = {0, static_cast<int>(surfs_.size())};
       continue;
     }
 
@@ -762,7 +1181,7 @@ UniversePartitioner::UniversePartitioner(const Universe& univ)
 
     // If there are no bounding z-planes, add this cell to all partitions.
     if (lower_token == 0) {
-      for (auto& p : partitions_) p.push_back(i_cell);
+      ranges[k] = {0, static_cast<int>(surfs_.size())};
       continue;
     }
 
@@ -792,48 +1211,77 @@ UniversePartitioner::UniversePartitioner(const Universe& univ)
       }
     }
 
-    // Add the cell to all relevant partitions.
-    for (int i = first_partition; i <= last_partition; ++i) {
-      partitions_[i].push_back(i_cell);
+    ranges[k] = {first_partition, last_partition};
+  }
+
+  // Populate the partition lists.  They are built as one vector per partition
+  // and flattened to CSR form below.
+  std::vector<std::vector<int32_t>> partitions(surfs_.size() + 1);
+  for (size_t k = 0; k < univ.cells_.size(); ++k) {
+    for (int i = ranges[k].first; i <= ranges[k].second; ++i) {
+      partitions[i].push_back(univ.cells_[k]);
     }
   }
+
+  // Reorder the universe's cell list so that cells sharing a partition are
+  // adjacent.  A particle that stays within one partition then scans
+  // contiguous entries, and the fallback linear search over cells_ visits
+  // them in roughly spatial order rather than the arbitrary input order.
+  // The partitions hold global cell indices, so they need no remapping.
+  std::unordered_set<int32_t> placed;
+  std::vector<int32_t> reordered;
+  reordered.reserve(univ.cells_.size());
+  for (const auto& p : partitions) {
+    for (auto i_cell : p) {
+      if (placed.insert(i_cell).second) reordered.push_back(i_cell);
+    }
+  }
+  for (auto i_cell : univ.cells_) {
+    if (placed.insert(i_cell).second) reordered.push_back(i_cell);
+  }
+  univ.cells_ = std::move(reordered);
+
+  // Flatten the partition lists into CSR form so a lookup returns a span of
+  // one contiguous array rather than chasing an inner vector.
+  partition_offsets_.reserve(partitions.size() + 1);
+  partition_offsets_.push_back(0);
+  for (const auto& p : partitions) {
+    partition_offsets_.push_back(partition_offsets_.back() + p.size());
+  }
+  partition_cells_.reserve(partition_offsets_.back());
+  for (const auto& p : partitions) {
+    partition_cells_.insert(partition_cells_.end(), p.begin(), p.end());
+  }
 }
 
-const std::vector<int32_t>&
+gsl::span<const int32_t>
 UniversePartitioner::get_cells(Position r, Direction u) const
 {
-  // Perform a binary search for the partition containing the given coordinates.
-  int left = 0;
-  int middle = (surfs_.size() - 1) / 2;
-  int right = surfs_.size() - 1;
-  while (true) {
-    // Check the sense of the coordinates for the current surface.
-    const auto& surf = *model::surfaces[surfs_[middle]];
-    if (surf.sense(r, u)) {
-      // The coordinates lie in the positive halfspace.  Recurse if there are
-      // more surfaces to check.  Otherwise, return the cells on the positive
-      // side of this surface.
-      int right_leaf = right - (right - middle) / 2;
-      if (right_leaf != middle) {
-        left = middle + 1;
-        middle = right_leaf;
-      } else {
-        return partitions_[middle+1];
-      }
-
-    } else {
-      // The coordinates lie in the negative halfspace.  Recurse if there are
-      // more surfaces to check.  Otherwise, return the cells on the negative
-      // side of this surface.
-      int left_leaf = left + (middle - left) / 2;
-      if (left_leaf != middle) {
-        right = middle-1;
-        middle = left_leaf;
-      } else {
-        return partitions_[middle];
-      }
-    }
+  // Search for the partition containing the given coordinates.  The partition
+  // index is the number of planes that lie below the point, so this is a
+  // branchless binary search over the cached z0_ values; the conditional
+  // advance compiles to a conditional move rather than a mispredictable
+  // branch.
+  const double* base = surf_z_.data();
+  size_t n = surf_z_.size();
+  while (n > 1) {
+    size_t half = n / 2;
+    base = (r.z > base[half - 1]) ? base + half : base;
+    n -= half;
   }
+  size_t i = (base - surf_z_.data()) + (r.z > *base ? 1 : 0);
+
+  // If the point is coincident with one of the bounding planes, break the tie
+  // with the direction of travel like Surface::sense does.
+  if (i > 0 && std::abs(r.z - surf_z_[i-1]) < FP_COINCIDENT) {
+    i = (u.z > 0.0) ? i : i - 1;
+  } else if (i < surf_z_.size()
+             && std::abs(r.z - surf_z_[i]) < FP_COINCIDENT) {
+    i = (u.z > 0.0) ? i + 1 : i;
+  }
+
+  return {partition_cells_.data() + partition_offsets_[i],
+    partition_cells_.data() + partition_offsets_[i+1]};
 }
 
 //==============================================================================
@@ -849,10 +1297,15 @@ void read_cells(pugi::xml_node node)
     fatal_error("No cells found in geometry.xml!");
   }
 
-  // Loop over XML cell elements and populate the array.
+  // Loop over XML cell elements and populate the arena and pointer array.
+  // The arena is reserved for the full cell count so the pointers taken here
+  // stay valid.
   model::cells.reserve(n_cells);
+  model::csg_cells.reserve(n_cells);
+  model::cell_map.reserve(n_cells);
   for (pugi::xml_node cell_node : node.children("cell")) {
-    model::cells.push_back(std::make_unique<CSGCell>(cell_node));
+    model::csg_cells.emplace_back(cell_node);
+    model::cells.push_back(&model::csg_cells.back());
   }
 
   // Fill the cell map.
@@ -889,6 +1342,94 @@ void read_cells(pugi::xml_node node)
   }
 }
 
+//==============================================================================
+
+void flatten_cell_rpn()
+{
+  auto n_cells = model::cells.size();
+
+  // Count the total number of RPN tokens so the flat array can be allocated
+  // in one shot.
+  size_t n_tokens = 0;
+  for (const auto& c : model::cells) n_tokens += c->rpn_.size();
+
+  model::cell_rpn_offsets.clear();
+  model::cell_rpn_offsets.reserve(n_cells + 1);
+  model::cell_rpn_tokens.clear();
+  model::cell_rpn_tokens.reserve(n_tokens);
+  model::cell_rpn_coeffs.clear();
+  model::cell_rpn_coeffs.reserve(n_tokens);
+
+  // Pack each cell's token stream back-to-back in CSR form.  The surface
+  // coefficients for each half-space token are cached alongside so sense
+  // evaluation in the common case needs neither a surface lookup nor a
+  // virtual call.
+  for (int32_t i = 0; i < n_cells; ++i) {
+    Cell& c = *model::cells[i];
+    c.index_ = i;
+    model::cell_rpn_offsets.push_back(model::cell_rpn_tokens.size());
+    for (int32_t token : c.rpn_) {
+      model::cell_rpn_tokens.push_back(token);
+      if (token < OP_UNION) {
+        // Note the off-by-one indexing
+        model::cell_rpn_coeffs.push_back(
+          surface_coeffs(*model::surfaces[abs(token)-1]));
+      } else {
+        model::cell_rpn_coeffs.push_back(SurfaceCoeffs {});
+      }
+    }
+  }
+  model::cell_rpn_offsets.push_back(model::cell_rpn_tokens.size());
+
+  // Mirror the stream in 16 bits if every token fits; the narrower stream
+  // halves the bytes the contains/distance loops read per cell.  Surface
+  // tokens must stay clear of the operator range at the top of the int16
+  // values.
+  model::cell_rpn_tokens16.clear();
+  model::cell_rpn_tokens16.reserve(model::cell_rpn_tokens.size());
+  for (int32_t token : model::cell_rpn_tokens) {
+    int16_t t16;
+    if (token == OP_UNION) {
+      t16 = OP16_UNION;
+    } else if (token == OP_INTERSECTION) {
+      t16 = OP16_INTERSECTION;
+    } else if (token == OP_COMPLEMENT) {
+      t16 = OP16_COMPLEMENT;
+    } else if (std::abs(token) < OP16_UNION) {
+      t16 = token;
+    } else {
+      // A token too large for 16 bits; keep using the 32-bit stream.
+      model::cell_rpn_tokens16.clear();
+      model::cell_rpn_tokens16.shrink_to_fit();
+      return;
+    }
+    model::cell_rpn_tokens16.push_back(t16);
+  }
+}
+
+//==============================================================================
+
+void flatten_cell_temperatures()
+{
+  auto n_cells = model::cells.size();
+
+  size_t n_temps = 0;
+  for (const auto& c : model::cells) n_temps += c->sqrtkT_.size();
+
+  // Pack each cell's temperatures back-to-back; instance j of cell i lands
+  // at cell_sqrtkT_offsets[i] + j.
+  model::cell_sqrtkT_offsets.clear();
+  model::cell_sqrtkT_offsets.reserve(n_cells + 1);
+  model::cell_sqrtkT.clear();
+  model::cell_sqrtkT.reserve(n_temps);
+  for (const auto& c : model::cells) {
+    model::cell_sqrtkT_offsets.push_back(model::cell_sqrtkT.size());
+    model::cell_sqrtkT.insert(model::cell_sqrtkT.end(),
+      c->sqrtkT_.begin(), c->sqrtkT_.end());
+  }
+  model::cell_sqrtkT_offsets.push_back(model::cell_sqrtkT.size());
+}
+
 //==============================================================================
 // C-API functions
 //==============================================================================
@@ -1030,15 +1571,55 @@ openmc_extend_cells(int32_t n, int32_t* index_start, int32_t* index_end)
 {
   if (index_start) *index_start = model::cells.size();
   if (index_end) *index_end = model::cells.size() + n - 1;
+
+  // Growing the arena may reallocate it, so remap any pointers into the old
+  // buffer by their offset before appending the new cells.
+  auto* old_data = model::csg_cells.data();
+  auto old_size = model::csg_cells.size();
+  model::csg_cells.reserve(old_size + n);
+  if (model::csg_cells.data() != old_data) {
+    for (auto& c : model::cells) {
+      auto* p = static_cast<CSGCell*>(c);
+      if (p >= old_data && p < old_data + old_size) {
+        c = model::csg_cells.data() + (p - old_data);
+      }
+    }
+  }
+
   for (int32_t i = 0; i < n; i++) {
-    model::cells.push_back(std::make_unique<CSGCell>());
+    model::csg_cells.emplace_back();
+    model::cells.push_back(&model::csg_cells.back());
   }
   return 0;
 }
 
 #ifdef DAGMC
+//! Generation counter for the per-thread next_cell caches.  It is bumped by
+//! invalidate_next_cell_cache() when the DAGMC model is freed, so caches
+//! built against a previous geometry are discarded after a reload.
+static int32_t next_cell_cache_generation {0};
+
+void invalidate_next_cell_cache()
+{
+  ++next_cell_cache_generation;
+}
+
 int32_t next_cell(DAGCell* cur_cell, DAGSurface* surf_xed)
 {
+  // The (cell, surface) -> next cell relation is fixed by the geometry, so
+  // cache it and only pay for the MOAB topology query on the first crossing
+  // of each pair.  The cache is thread local to avoid locking.
+  static thread_local std::unordered_map<uint64_t, int32_t> cache;
+  static thread_local int32_t cache_generation {0};
+  if (cache_generation != next_cell_cache_generation) {
+    cache.clear();
+    cache_generation = next_cell_cache_generation;
+  }
+  uint64_t key = (static_cast<uint64_t>(cur_cell->dag_index_) << 32)
+                 | static_cast<uint32_t>(surf_xed->dag_index_);
+  auto it = cache.find(key);
+  if (it != cache.end()) return it->second;
+
   moab::EntityHandle surf =
     surf_xed->dagmc_ptr_->entity_by_index(2, surf_xed->dag_index_);
   moab::EntityHandle vol =
@@ -1047,7 +1628,9 @@ int32_t next_cell(DAGCell* cur_cell, DAGSurface* surf_xed)
   moab::EntityHandle new_vol;
   cur_cell->dagmc_ptr_->next_vol(surf, vol, new_vol);
 
-  return cur_cell->dagmc_ptr_->index_by_handle(new_vol);
+  int32_t i_cell = cur_cell->dagmc_ptr_->index_by_handle(new_vol);
+  cache.emplace(key, i_cell);
+  return i_cell;
 }
 #endif
 
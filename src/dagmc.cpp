@@ -190,18 +190,23 @@ void load_dagmc_geometry()
   // initialize cell objects
   int n_cells = model::DAG->num_entities(3);
   moab::EntityHandle graveyard = 0;
+  // Reserve the arena for the full cell count so the pointers taken below
+  // stay valid.
+  model::cells.reserve(n_cells);
+  model::dag_cells.reserve(n_cells);
   for (int i = 0; i < n_cells; i++) {
     moab::EntityHandle vol_handle = model::DAG->entity_by_index(3, i+1);
 
     // set cell ids using global IDs
-    DAGCell* c = new DAGCell();
+    model::dag_cells.emplace_back();
+    DAGCell* c = &model::dag_cells.back();
     c->dag_index_ = i+1;
     c->id_ = model::DAG->id_by_index(3, c->dag_index_);
     c->dagmc_ptr_ = model::DAG;
     c->universe_ = dagmc_univ_id; // set to zero for now
     c->fill_ = C_NONE; // no fill, single universe
 
-    model::cells.emplace_back(c);
+    model::cells.push_back(c);
     model::cell_map[c->id_] = i;
 
     // Populate the Universe vector and dict
@@ -382,6 +387,7 @@ void read_geometry_dagmc()
 
 void free_memory_dagmc()
 {
+  invalidate_next_cell_cache();
   delete model::DAG;
 }
 
@@ -1,6 +1,7 @@
 #include "openmc/geometry.h"
 
 #include <array>
+#include <iterator> // for next
 #include <sstream>
 
 #include "openmc/cell.h"
@@ -75,6 +76,16 @@ find_cell_inner(Particle* p, const NeighborList* neighbor_list)
     for (auto it = neighbor_list->cbegin(); it != neighbor_list->cend(); ++it) {
       i_cell = *it;
 
+#ifdef __GNUC__
+      // Start loading the next candidate while this one is tested.  The cells
+      // live contiguously in the arena, so the prefetch hides most of the
+      // miss latency behind the contains() call below.
+      auto next = std::next(it);
+      if (next != neighbor_list->cend()) {
+        __builtin_prefetch(model::cells[*next], 0, 1);
+      }
+#endif
+
       // Make sure the search cell is in the same universe.
       int i_universe = p->coord_[p->n_coord_-1].universe;
       if (model::cells[i_cell]->universe_ != i_universe) continue;
@@ -93,12 +104,12 @@ find_cell_inner(Particle* p, const NeighborList* neighbor_list)
   } else {
     int i_universe = p->coord_[p->n_coord_-1].universe;
     const auto& univ {*model::universes[i_universe]};
-    const auto& cells {
+    gsl::span<const int32_t> cells {
       !univ.partitioner_
-      ? model::universes[i_universe]->cells_
+      ? gsl::span<const int32_t>{univ.cells_}
       : univ.partitioner_->get_cells(p->r_local(), p->u_local())
     };
-    for (auto it = cells.cbegin(); it != cells.cend(); it++) {
+    for (auto it = cells.begin(); it != cells.end(); it++) {
       i_cell = *it;
 
       // Make sure the search cell is in the same universe.
@@ -160,7 +171,14 @@ find_cell_inner(Particle* p, const NeighborList* neighbor_list)
         p->material_ = c.material_[0];
       }
       p->sqrtkT_last_ = p->sqrtkT_;
-      if (c.sqrtkT_.size() > 1) {
+      if (i_cell + 1
+          < static_cast<int64_t>(model::cell_sqrtkT_offsets.size())) {
+        // Read the flattened temperature table; cells with a single
+        // temperature use instance 0.
+        auto start = model::cell_sqrtkT_offsets[i_cell];
+        auto n_T = model::cell_sqrtkT_offsets[i_cell+1] - start;
+        p->sqrtkT_ = model::cell_sqrtkT[start + (n_T > 1 ? p->cell_instance_ : 0)];
+      } else if (c.sqrtkT_.size() > 1) {
         p->sqrtkT_ = c.sqrtkT_[p->cell_instance_];
       } else {
         p->sqrtkT_ = c.sqrtkT_[0];
@@ -184,7 +202,7 @@ find_cell_inner(Particle* p, const NeighborList* neighbor_list)
       coord.r -= c.translation_;
 
       // Apply rotation.
-      if (!c.rotation_.empty()) {
+      if (c.has_rotation_) {
         coord.rotate(c.rotation_);
       }
 
@@ -207,7 +225,7 @@ find_cell_inner(Particle* p, const NeighborList* neighbor_list)
       coord.r -= c.translation_;
 
       // Apply rotation.
-      if (!c.rotation_.empty()) {
+      if (c.has_rotation_) {
         coord.rotate(c.rotation_);
       }
 
@@ -317,7 +335,7 @@ cross_lattice(Particle* p, const BoundaryInfo& boundary)
   const auto& cell {model::cells[upper_coord.cell]};
   Position r = upper_coord.r;
   r -= cell->translation_;
-  if (!cell->rotation_.empty()) {
+  if (cell->has_rotation_) {
     r = r.rotate(cell->rotation_);
   }
   p->r_local() = lat.get_local_position(r, i_xyz);
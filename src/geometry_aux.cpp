@@ -244,10 +244,12 @@ void finalize_geometry(std::vector<std::vector<double>>& nuc_temps,
   // Perform some final operations to set up the geometry
   adjust_indices();
   count_cell_instances(model::root_universe);
+  flatten_cell_rpn();
   partition_universes();
 
   // Assign temperatures to cells that don't have temperatures already assigned
   assign_temperatures();
+  flatten_cell_temperatures();
 
   // Determine desired temperatures for each nuclide and S(a,b) table
   get_temperatures(nuc_temps, thermal_temps);
@@ -555,6 +557,10 @@ void
 free_memory_geometry()
 {
   model::cells.clear();
+  model::csg_cells.clear();
+#ifdef DAGMC
+  model::dag_cells.clear();
+#endif
   model::cell_map.clear();
 
   model::universes.clear();
@@ -34,7 +34,7 @@ namespace openmc {
 //==============================================================================
 
 void
-LocalCoord::rotate(const std::vector<double>& rotation)
+LocalCoord::rotate(const std::array<double, 12>& rotation)
 {
   this->r = this->r.rotate(rotation);
   this->u = this->u.rotate(rotation);
@@ -551,7 +551,7 @@ Particle::cross_surface()
 
 #ifdef DAGMC
   if (settings::dagmc) {
-    auto cellp = dynamic_cast<DAGCell*>(model::cells[cell_last_[0]].get());
+    auto cellp = dynamic_cast<DAGCell*>(model::cells[cell_last_[0]]);
     // TODO: off-by-one
     auto surfp = dynamic_cast<DAGSurface*>(model::surfaces[std::abs(surface_) - 1].get());
     int32_t i_cell = next_cell(cellp, surfp) - 1;
@@ -85,7 +85,7 @@ Position::operator-() const
 }
 
 Position
-Position::rotate(const std::vector<double>& rotation) const
+Position::rotate(const std::array<double, 12>& rotation) const
 {
   return {
     x*rotation[3] + y*rotation[4] + z*rotation[5],
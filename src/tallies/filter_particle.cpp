@@ -1,5 +1,11 @@
 #include "openmc/tallies/filter_particle.h"
 
+#include <algorithm> // for min
+#include <array>
+#include <cstdint>
+
+#include "openmc/error.h"
+#include "openmc/hdf5_interface.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -11,6 +17,7 @@ ParticleFilter::from_xml(pugi::xml_node node)
 
   // Convert to vector of Particle::Type
   std::vector<Particle::Type> types;
+  types.reserve(particles.size());
   for (auto& p : particles) {
     types.push_back(static_cast<Particle::Type>(p - 1));
   }
@@ -29,17 +36,65 @@ ParticleFilter::set_particles(gsl::span<Particle::Type> particles)
     particles_.push_back(p);
   }
   n_bins_ = particles_.size();
+
+  // Precompute the bin for each particle type so get_all_bins can look it up
+  // directly.  If a type somehow appears in more than one bin, fall back to
+  // scanning particles_.
+  bin_of_type_.fill(-1);
+  duplicate_bins_ = false;
+  for (size_t i = 0; i < particles_.size(); ++i) {
+    auto t = static_cast<int>(particles_[i]);
+    // The types come straight from user XML, so check them before they are
+    // used to index the table.
+    if (t < 0 || t >= static_cast<int>(bin_of_type_.size())) {
+      fatal_error("Invalid particle type " + std::to_string(t + 1)
+        + " in particle filter.");
+    }
+    if (bin_of_type_[t] >= 0) {
+      duplicate_bins_ = true;
+    } else {
+      bin_of_type_[t] = i;
+    }
+  }
 }
 
 void
 ParticleFilter::get_all_bins(const Particle* p, int estimator,
                              FilterMatch& match) const
 {
-  for (auto i = 0; i < particles_.size(); i++) {
-    if (particles_[i] == p->type_) {
-      match.bins_.push_back(i);
+  // In the common case each particle type maps to at most one bin, so the
+  // match is a single table lookup.
+  if (!duplicate_bins_) {
+    int8_t b = bin_of_type_[static_cast<int>(p->type_)];
+    if (b >= 0) {
+      match.bins_.push_back(b);
       match.weights_.push_back(1.0);
     }
+    return;
+  }
+
+  // Build a bitmask of matching bins, then expand the set bits.  The
+  // comparison loop carries no data-dependent branches, so the compiler can
+  // vectorize it; expansion only touches bins that actually matched.
+  const auto type = p->type_;
+  const size_t n = particles_.size();
+  for (size_t base = 0; base < n; base += 64) {
+    const size_t chunk = std::min<size_t>(64, n - base);
+    uint64_t mask = 0;
+    for (size_t i = 0; i < chunk; ++i) {
+      mask |= static_cast<uint64_t>(particles_[base + i] == type) << i;
+    }
+    while (mask) {
+#ifdef __GNUC__
+      int i = __builtin_ctzll(mask);
+#else
+      int i = 0;
+      while (!(mask >> i & 1)) ++i;
+#endif
+      match.bins_.push_back(base + i);
+      match.weights_.push_back(1.0);
+      mask &= mask - 1;
+    }
   }
 }
 
@@ -47,27 +102,31 @@ void
 ParticleFilter::to_statepoint(hid_t filter_group) const
 {
   Filter::to_statepoint(filter_group);
-  std::vector<int> particles;
-  for (auto p : particles_) {
-    particles.push_back(static_cast<int>(p) + 1);
+
+  // The bins are written 1-based.  A particle filter only ever has a handful
+  // of bins, so shift them through a stack buffer instead of building a
+  // temporary vector for every filter.
+  std::array<int, 8> buffer;
+  std::vector<int> overflow;
+  int* bins = buffer.data();
+  if (particles_.size() > buffer.size()) {
+    overflow.resize(particles_.size());
+    bins = overflow.data();
+  }
+  for (size_t i = 0; i < particles_.size(); ++i) {
+    bins[i] = static_cast<int>(particles_[i]) + 1;
   }
-  write_dataset(filter_group, "bins", particles);
+  hsize_t n = particles_.size();
+  write_dataset(filter_group, 1, &n, "bins", H5T_NATIVE_INT, bins, false);
 }
 
 std::string
 ParticleFilter::text_label(int bin) const
 {
-  switch (particles_[bin]) {
-  case Particle::Type::neutron:
-    return "Particle: neutron";
-  case Particle::Type::photon:
-    return "Particle: photon";
-  case Particle::Type::electron:
-    return "Particle: electron";
-  case Particle::Type::positron:
-    return "Particle: positron";
-  }
-  UNREACHABLE();
+  // Indexed by Particle::Type.
+  constexpr const char* labels[] {"Particle: neutron", "Particle: photon",
+    "Particle: electron", "Particle: positron"};
+  return labels[static_cast<int>(particles_[bin])];
 }
 
 } // namespace openmc